@@ -9,6 +9,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <list>
+#include <memory>
+
+namespace cpr { class Session; }
 
 class Crawler {
 public:
@@ -18,6 +22,7 @@ public:
             int maxConcurrency,
             int delayMs,
             std::vector<std::string> targetExtensions = {".pdf"});
+    ~Crawler();
 
     void run();
 
@@ -73,6 +78,24 @@ private:
     std::condition_variable download_cv_;
     std::atomic<int> pending_downloads_{0};
 
+    // Shared DNS/TLS session cache; declared before the sessions that use it
+    struct CurlShare;
+    std::unique_ptr<CurlShare> share_;
+
+    // Idle sessions keyed by origin, most recently used first
+    std::list<std::pair<std::string, std::unique_ptr<cpr::Session>>> idleSessions_;
+    std::mutex pool_mtx_;
+    std::unique_ptr<cpr::Session> robotsSession_;  // taken by the first crawler to fetch a page
+
+    // Warm-up of newly discovered file hosts
+    struct WarmupTask { std::string url; std::string referer; };
+    std::unordered_set<std::string> warmedHosts_;   // origins ever queued for warm-up
+    std::unordered_set<std::string> warmingHosts_;  // origins whose warm-up request is in flight
+    std::deque<WarmupTask> warmup_queue_;
+    std::mutex warmup_mtx_;
+    std::condition_variable warmup_cv_;
+    bool warmup_stop_ = false;
+
     // Core helpers
     static std::string to_lower(const std::string& s);
     static std::optional<UrlParts> parse_url(const std::string& url);
@@ -97,9 +120,18 @@ private:
     static std::string sanitize_filename(const std::string& name);
 
     std::vector<std::string> extract_links(const std::string& html, const std::string& base_url) const;
-    std::string fetch_text(const std::string& url, long* status = nullptr);
-
-    std::optional<std::pair<long,long long>> download_to_file(const std::string& url,
+    std::string fetch_text(cpr::Session& session, const std::string& url, long* status = nullptr);
+
+    static std::string origin_of(const std::string& url);
+    std::unique_ptr<cpr::Session> make_session() const;
+    std::unique_ptr<cpr::Session> checkout_session(const std::string& origin);
+    void checkin_session(const std::string& origin, std::unique_ptr<cpr::Session> session);
+    void prefetch_host(const std::string& url, const std::string& referer);
+    void warm_host(const WarmupTask& task);
+    std::unique_ptr<cpr::Session> await_warm_session(const std::string& origin);
+
+    std::optional<std::pair<long,long long>> download_to_file(cpr::Session& session,
+                                                             const std::string& url,
                                                              const std::string& filepath,
                                                              const std::unordered_map<std::string,std::string>& headers = {});
 
@@ -110,4 +142,5 @@ private:
     // Workers
     void crawl_worker();
     void download_worker();
+    void warmup_worker();
 };